@@ -0,0 +1,151 @@
+//
+// Flock health metrics
+//
+
+#include <algorithm>
+#include <numeric>
+#include "analytics.h"
+#include "vector_utils.h"
+
+std::ostream& operator << (std::ostream& os, const FlockMetrics& metrics) {
+    os << "Frame " << metrics.frame << ": " << metrics.boids << " boids";
+    for (std::size_t index = 0; index < metrics.species.size(); ++index) {
+        const auto& species = metrics.species[index];
+        os << "; species " << index << ": " << species.boids << " boids, polarisation " << species.polarisation;
+        if (not species.perceives_own_species) {
+            os << ", clusters n/a";
+            continue;
+        }
+        os << ", clusters " << species.clusters << " (largest " << species.largest_cluster << ")"
+           << ", isolated " << species.isolated
+           << ", nn distance min/p10/median/p90/max " << species.nn_min << "/" << species.nn_p10 << "/"
+           << species.nn_median << "/" << species.nn_p90 << "/" << species.nn_max
+           << " mean " << species.nn_mean;
+    }
+    return os;
+}
+
+bool FlockAnalytics::begin_frame(std::size_t capacity) {
+    just_published = false;
+    sampling_frame = interval > 0 and frame % interval == 0;
+    frame++;
+    if (not sampling_frame) return false;
+
+    for (auto& accumulator : accumulators) {
+        accumulator.heading_sum = sf::Vector3f(0, 0, 0);
+        accumulator.perceives_own_species = false;
+        accumulator.observed.clear();
+        accumulator.nearest_distances.clear();
+    }
+    parent.resize(capacity);
+    cluster_size.resize(capacity);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::fill(cluster_size.begin(), cluster_size.end(), 1);
+    return true;
+}
+
+template <int Dim>
+FlockAnalytics::SpeciesAccumulator& FlockAnalytics::record_heading(const BasicBoid<Dim>& boid) {
+    auto species = static_cast<std::size_t>(boid.species);
+    if (species >= accumulators.size()) {
+        accumulators.resize(species + 1);
+    }
+    auto& accumulator = accumulators[species];
+    auto heading = normalise(boid.get_velocity());
+    for (int axis = 0; axis < Dim; ++axis) {
+        component(accumulator.heading_sum, axis) += component(heading, axis);
+    }
+    accumulator.observed.push_back(boid.ID);
+    return accumulator;
+}
+
+template <int Dim>
+void FlockAnalytics::observe(const BasicBoid<Dim>& boid, const std::vector<BasicBoid<Dim>*>& neighbours) {
+    auto& accumulator = record_heading(boid);
+    accumulator.perceives_own_species = true;
+
+    float nearest = -1;
+    for (const auto& neighbour : neighbours) {
+        if (neighbour->ID == boid.ID) continue;
+        float distance = magnitude(neighbour->get_position() - boid.get_position());
+        if (nearest < 0 or distance < nearest) nearest = distance;
+        unite(boid.ID, neighbour->ID);
+    }
+    if (nearest >= 0) {
+        accumulator.nearest_distances.push_back(nearest);
+    }
+}
+
+template <int Dim>
+void FlockAnalytics::observe(const BasicBoid<Dim>& boid) {
+    record_heading(boid);
+}
+
+template void FlockAnalytics::observe<2>(const Boid&, const std::vector<Boid*>&);
+template void FlockAnalytics::observe<3>(const Boid3&, const std::vector<Boid3*>&);
+template void FlockAnalytics::observe<2>(const Boid&);
+template void FlockAnalytics::observe<3>(const Boid3&);
+
+void FlockAnalytics::end_frame() {
+    if (not sampling_frame) return;
+
+    metrics = FlockMetrics();
+    metrics.frame = frame - 1;
+    metrics.species.resize(accumulators.size());
+    for (std::size_t index = 0; index < accumulators.size(); ++index) {
+        summarise(accumulators[index], metrics.species[index]);
+        metrics.boids += metrics.species[index].boids;
+    }
+    just_published = true;
+}
+
+void FlockAnalytics::summarise(SpeciesAccumulator& accumulator, SpeciesMetrics& species) {
+    species.boids = accumulator.observed.size();
+    if (accumulator.observed.empty()) return;
+
+    species.polarisation = magnitude(accumulator.heading_sum) / species.boids;
+    species.perceives_own_species = accumulator.perceives_own_species;
+    if (not accumulator.perceives_own_species) return;
+
+    // Neighbours are only ever united within a species, so each root here is one of this species' clusters
+    for (int id : accumulator.observed) {
+        if (find(id) == static_cast<std::uint32_t>(id)) {
+            species.clusters++;
+            species.largest_cluster = std::max<std::size_t>(species.largest_cluster, cluster_size[id]);
+        }
+    }
+
+    auto& distances = accumulator.nearest_distances;
+    species.isolated = species.boids - distances.size();
+    if (not distances.empty()) {
+        auto quantile = [&distances](float q) {
+            auto nth = distances.begin() + static_cast<std::size_t>(q * (distances.size() - 1));
+            std::nth_element(distances.begin(), nth, distances.end());
+            return *nth;
+        };
+        species.nn_p10 = quantile(0.1f);
+        species.nn_median = quantile(0.5f);
+        species.nn_p90 = quantile(0.9f);
+        auto [min, max] = std::minmax_element(distances.begin(), distances.end());
+        species.nn_min = *min;
+        species.nn_max = *max;
+        species.nn_mean = std::accumulate(distances.begin(), distances.end(), 0.0f) / distances.size();
+    }
+}
+
+std::uint32_t FlockAnalytics::find(std::uint32_t id) {
+    while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+    return id;
+}
+
+void FlockAnalytics::unite(std::uint32_t a, std::uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return;
+    if (cluster_size[a] < cluster_size[b]) std::swap(a, b);
+    parent[b] = a;
+    cluster_size[a] += cluster_size[b];
+}
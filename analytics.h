@@ -0,0 +1,105 @@
+//
+// Flock health metrics computed inside the simulation step from the neighbour lists the rules already use
+//
+
+#ifndef BOIDS_ANALYTICS_H
+#define BOIDS_ANALYTICS_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "boid.h"
+
+/// Metrics for the boids of one species
+struct SpeciesMetrics
+{
+    std::size_t boids = 0;
+
+    /// Length of the mean heading vector, 1 when every boid faces the same way, near 0 when headings are random
+    float polarisation = 0;
+
+    /// False if the species has no rules for its own kind, in which case the species never queries its own layer
+    /// and the neighbour metrics below are not measured
+    bool perceives_own_species = false;
+
+    /// Connected components of the perception graph between boids of this species
+    std::size_t clusters = 0;
+    std::size_t largest_cluster = 0;
+
+    /// Distribution of distances to the nearest neighbour of the same species, over boids that have one
+    std::size_t isolated = 0;
+    float nn_min = 0;
+    float nn_p10 = 0;
+    float nn_median = 0;
+    float nn_p90 = 0;
+    float nn_max = 0;
+    float nn_mean = 0;
+};
+
+struct FlockMetrics
+{
+    std::size_t frame = 0;
+    std::size_t boids = 0;
+
+    /// Indexed by species number. Species with no boids have default metrics.
+    std::vector<SpeciesMetrics> species;
+};
+
+std::ostream& operator << (std::ostream& os, const FlockMetrics& metrics);
+
+/// Accumulates FlockMetrics every `interval` frames. On other frames begin_frame() returns false and the step
+/// skips calling observe(), so the overhead is confined to sampled frames.
+class FlockAnalytics
+{
+public:
+    explicit FlockAnalytics(int interval) : interval(interval) {}
+
+    /// Starts a frame. `capacity` bounds the IDs of the boids that will be observed.
+    bool begin_frame(std::size_t capacity);
+
+    /// Records one boid and its same-species neighbours (which may include the boid itself)
+    template <int Dim>
+    void observe(const BasicBoid<Dim>& boid, const std::vector<BasicBoid<Dim>*>& neighbours);
+
+    /// Records a boid whose species doesn't perceive its own kind, so only its heading is known
+    template <int Dim>
+    void observe(const BasicBoid<Dim>& boid);
+
+    /// Finishes a sampled frame and publishes its metrics
+    void end_frame();
+
+    bool sampling() const { return sampling_frame; }
+
+    /// True on the frame a new set of metrics was published
+    bool published() const { return just_published; }
+    const FlockMetrics& latest() const { return metrics; }
+
+private:
+    int interval;
+    std::size_t frame = 0;
+    bool sampling_frame = false;
+    bool just_published = false;
+    FlockMetrics metrics;
+
+    // Per-frame accumulators, indexed by species
+    struct SpeciesAccumulator
+    {
+        sf::Vector3f heading_sum;
+        bool perceives_own_species = false;
+        std::vector<int> observed;
+        std::vector<float> nearest_distances;
+    };
+    std::vector<SpeciesAccumulator> accumulators;
+
+    // Union-find over boid IDs, with union by size and path halving
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> cluster_size;
+
+    template <int Dim>
+    SpeciesAccumulator& record_heading(const BasicBoid<Dim>& boid);
+    void summarise(SpeciesAccumulator& accumulator, SpeciesMetrics& species);
+    std::uint32_t find(std::uint32_t id);
+    void unite(std::uint32_t a, std::uint32_t b);
+};
+
+#endif //BOIDS_ANALYTICS_H
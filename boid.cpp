@@ -10,55 +10,51 @@
 #include "boid.h"
 #include "vector_utils.h"
 
-Boid::Boid(sf::Vector2f initial_position,
-           sf::Vector2f initial_velocity,
-           float max_speed,
-           float max_force,
-           float perception_radius,
-           float height,
-           float width,
-           sf::Color colour,
-           int ID)
-   : position(initial_position),
-     velocity(initial_velocity),
-     max_speed(max_speed),
-     max_force(max_force),
-     perception(perception_radius),
-     ID(ID)
+template <int Dim>
+BasicBoid<Dim>::BasicBoid(Vec initial_position,
+                          Vec initial_velocity,
+                          const BoidParameters* params,
+                          int species,
+                          sf::Color colour,
+                          int ID)
+   : params(params),
+     species(species),
+     ID(ID),
+     position(initial_position),
+     velocity(initial_velocity)
 {
-    sprite = create_sprite(height, width, colour);
-}
-
-sf::ConvexShape Boid::get_drawable() {
-    float rotation = velocity_to_rotation();
-    sprite.setRotation(rotation);
-    sprite.setPosition(position);
-    return sprite;
+    if constexpr (Dim == 2) {
+        sprite = create_sprite(params->height, params->width, colour);
+    }
 }
 
-void Boid::apply_force(sf::Vector2f force) {
-    acceleration = normalise(force) * max_force;
+template <int Dim>
+void BasicBoid<Dim>::apply_force(Vec force) {
+    acceleration = normalise(force) * params->max_force;
 }
 
-void Boid::update(sf::Time tick) {
+template <int Dim>
+void BasicBoid<Dim>::update(sf::Time tick, Vec extent) {
     position += velocity * (float)tick.asSeconds();
 
-    if (position.x < 0) position.x += 1920.0f;
-    if (position.x > 1920.0f) position.x -= 1920.0f;
-    if (position.y < 0) position.y += 1080.0f;
-    if (position.y > 1080.0f) position.y -= 1080.0f;
+    for (int axis = 0; axis < Dim; ++axis) {
+        float& x = component(position, axis);
+        if (x < 0) x += component(extent, axis);
+        if (x > component(extent, axis)) x -= component(extent, axis);
+    }
 
 
     velocity += acceleration * (float)tick.asSeconds();
 
-    if (magnitude(velocity) > max_speed) {
-        velocity = velocity / magnitude(velocity) * max_speed;
+    if (magnitude(velocity) > params->max_speed) {
+        velocity = velocity / magnitude(velocity) * params->max_speed;
     }
 
-    acceleration = sf::Vector2f(0.0, 0.0);
+    acceleration = Vec();
 }
 
-sf::ConvexShape Boid::create_sprite(float height, float width, sf::Color colour) {
+template <int Dim>
+sf::ConvexShape BasicBoid<Dim>::create_sprite(float height, float width, sf::Color colour) {
     sf::ConvexShape shape(4);
     shape.setPoint(0, sf::Vector2f(2.0 * height / 3.0, 0));
     shape.setPoint(1, sf::Vector2f(-1.0 * height / 3.0, -width / 2.0));
@@ -68,9 +64,16 @@ sf::ConvexShape Boid::create_sprite(float height, float width, sf::Color colour)
     return shape;
 }
 
-void Boid::print() {
+template <int Dim>
+void BasicBoid<Dim>::print() {
     std::cout << "Boid #" << ID << ": pos" << to_str(position)
               << "; vel(" << to_str(velocity)
-              << "; acc(" << to_str(acceleration)
-              << "; dir(" << vector_to_rotation(velocity) << ")" << std::endl;
-}
\ No newline at end of file
+              << "; acc(" << to_str(acceleration);
+    if constexpr (Dim == 2) {
+        std::cout << "; dir(" << vector_to_rotation(velocity) << ")";
+    }
+    std::cout << std::endl;
+}
+
+template class BasicBoid<2>;
+template class BasicBoid<3>;
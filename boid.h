@@ -2,72 +2,93 @@
 // Created by Kevin Gori on 18/09/2020.
 //
 #include <cmath>
+#include <type_traits>
 #include <SFML/Graphics.hpp>
 #include "vector_utils.h"
 #ifndef BOIDS_BOID_H
 #define BOIDS_BOID_H
 
-class Boid
+/// Parameters shared by every boid of a species
+struct BoidParameters
+{
+    float max_speed;
+    float max_force;
+    float perception;
+    float height;
+    float width;
+};
+
+/// Stands in for the sprite of boids that aren't drawn (3D boids)
+struct NoSprite {};
+
+/// A boid in Dim dimensions. Boid (2D) is the one that gets drawn.
+template <int Dim>
+class BasicBoid
 {
 public:
-    Boid(sf::Vector2f position,
-         sf::Vector2f initial_velocity,
-         float max_speed,
-         float max_force,
-         float perception_radius,
-         float height,
-         float width,
-         sf::Color colour,
-         int ID);
+    using Vec = Vector<Dim>;
+
+    BasicBoid(Vec position,
+              Vec initial_velocity,
+              const BoidParameters* params,
+              int species,
+              sf::Color colour,
+              int ID);
 
     // Public methods
-    sf::ConvexShape get_drawable();
-    void apply_force(sf::Vector2f force);
-    void update(sf::Time tick);
+    template <int D = Dim, typename = std::enable_if_t<D == 2>>
+    sf::ConvexShape get_drawable() {
+        sprite.setRotation(vector_to_rotation(velocity));
+        sprite.setPosition(position);
+        return sprite;
+    }
+
+    void apply_force(Vec force);
+
+    /// Moves the boid, wrapping it around a world that spans [0, extent) along each axis
+    void update(sf::Time tick, Vec extent);
     void print();
 
-    inline sf::Vector2f get_position() const {
+    inline Vec get_position() const {
         return position;
     }
 
-    inline sf::Vector2f get_velocity() const {
+    inline Vec get_velocity() const {
         return velocity;
     }
 
-    inline void set_velocity(sf::Vector2f vel) {
+    inline Vec get_acceleration() const {
+        return acceleration;
+    }
+
+    inline void set_velocity(Vec vel) {
         velocity = vel;
     }
 
-    bool operator == (const Boid &rhs) const {
+    bool operator == (const BasicBoid &rhs) const {
         return position == rhs.position;
     }
 
-    bool operator != (const Boid &rhs) const {
+    bool operator != (const BasicBoid &rhs) const {
         return position != rhs.position;
     }
 
-    float perception;
-    float max_speed;
-    float max_force = 1;
+    const BoidParameters* params;
+    int species;
     int ID;
 
 private:
     // Private data
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    sf::Vector2f acceleration;
-    sf::ConvexShape sprite;
+    Vec position;
+    Vec velocity;
+    Vec acceleration;
+    std::conditional_t<Dim == 2, sf::ConvexShape, NoSprite> sprite;
 
     // Private methods
     sf::ConvexShape create_sprite(float height, float width, sf::Color colour);
-
-    inline float velocity_to_rotation() {
-        return vector_to_rotation(velocity);
-    }
-
-    inline float acceleration_to_rotation() {
-        return vector_to_rotation(acceleration);
-    }
 };
 
+using Boid = BasicBoid<2>;
+using Boid3 = BasicBoid<3>;
+
 #endif //BOIDS_BOID_H
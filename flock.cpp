@@ -0,0 +1,156 @@
+//
+// Multi-species flock with per-species spatial layers
+//
+
+#include <cassert>
+#include "flock.h"
+#include "vector_utils.h"
+
+template <int Dim>
+BasicFlock<Dim>::BasicFlock(Vec extent) : extent(extent) {
+    boids.on_spawn([this](Boid* boid) {
+        layers[boid->species].add(boid);
+        if (scheduler != nullptr) scheduler->reset(boid->ID);
+    });
+    boids.on_despawn([this](Boid* boid) {
+        // The layer must not keep a pointer to a boid the registry is about to free
+        bool removed = layers[boid->species].remove(boid);
+        assert(removed);
+        (void)removed;
+    });
+}
+
+template <int Dim>
+int BasicFlock<Dim>::add_species(std::string name, BoidParameters params) {
+    species.push_back(std::make_unique<Species>(std::move(name), params));
+    layers.emplace_back(Vec(), extent);
+    for (auto& row : interactions) {
+        row.emplace_back();
+    }
+    interactions.emplace_back(species.size());
+    return static_cast<int>(species.size()) - 1;
+}
+
+template <int Dim>
+void BasicFlock<Dim>::add_rule(int who, int to, std::unique_ptr<Rule<Dim>> rule) {
+    interactions[who][to].push_back(std::move(rule));
+}
+
+template <int Dim>
+Handle BasicFlock<Dim>::spawn(int species_index, Vec position, Vec velocity, sf::Color colour) {
+    return boids.spawn(position, velocity, &species[species_index]->params, species_index, colour);
+}
+
+template <int Dim>
+bool BasicFlock<Dim>::despawn(Handle handle) {
+    return boids.despawn(handle);
+}
+
+template <int Dim>
+void BasicFlock<Dim>::rebuild_index() {
+    for (auto& layer : layers) {
+        layer.clear();
+    }
+    for (auto& boid : boids) {
+        layers[boid->species].add(boid.get());
+    }
+}
+
+template <int Dim>
+void BasicFlock<Dim>::steer() {
+    bool sampling = analytics != nullptr and analytics->begin_frame(boids.capacity());
+    for (auto& boid : boids) {
+        if (scheduler != nullptr and not sampling and not scheduler->due(*boid)) {
+            boid->apply_force(scheduler->extrapolate(*boid));
+            continue;
+        }
+
+        Vec resultant_force;
+        auto boidPos = boid->get_position();
+        auto& row = interactions[boid->species];
+        std::size_t neighbour_count = 0;
+        std::uint32_t neighbour_signature = 0;
+        bool observed = false;
+        for (std::size_t other = 0; other < row.size(); ++other) {
+            if (row[other].empty()) continue;
+            auto neighbours = layers[other].getPointsWithinRadius(boidPos, boid->params->perception);
+            neighbour_count += neighbours.size();
+            if (scheduler != nullptr) {
+                for (auto neighbour : neighbours) {
+                    neighbour_signature ^= BasicUpdateScheduler<Dim>::id_signature(neighbour->ID);
+                }
+            }
+            for (auto& rule : row[other]) {
+                resultant_force += normalise(rule->apply_rule(*boid, neighbours)) * rule->weight;
+            }
+            if (sampling and other == static_cast<std::size_t>(boid->species)) {
+                analytics->observe(*boid, neighbours);
+                observed = true;
+            }
+        }
+        if (sampling and not observed) {
+            analytics->observe(*boid);
+        }
+        resultant_force = normalise(resultant_force);
+        boid->apply_force(resultant_force);
+        if (scheduler != nullptr) {
+            scheduler->record(*boid, resultant_force, neighbour_count, neighbour_signature);
+        }
+    }
+    if (sampling) {
+        analytics->end_frame();
+    }
+}
+
+template <int Dim>
+void BasicFlock<Dim>::update(sf::Time tick) {
+    for (auto& boid : boids) {
+        boid->update(tick, extent);
+    }
+    if (scheduler != nullptr) {
+        scheduler->advance(tick);
+    }
+}
+
+template <int Dim>
+template <int D, typename>
+CompactSnapshot BasicFlock<Dim>::snapshot(int species_index) {
+    CompactSnapshot result;
+    result.max_speed = species[species_index]->params.max_speed;
+    layers[species_index].forEachLeaf([&result](const RectangleBounds& bounds, const std::vector<Boid*>& items) {
+        if (items.empty()) return;
+        result.cells.push_back(CompactCell{bounds, static_cast<std::uint32_t>(result.states.size()),
+                                           static_cast<std::uint32_t>(items.size())});
+        for (auto boid : items) {
+            CompactBoidState state{encode_position(boid->get_position(), bounds),
+                                   encode_velocity(boid->get_velocity(), result.max_speed)};
+            assert(magnitude(decode_position(state.position, bounds) - boid->get_position())
+                   <= max_position_error(bounds));
+            assert(magnitude(decode_velocity(state.velocity, result.max_speed) - boid->get_velocity())
+                   <= max_velocity_error(result.max_speed));
+            result.states.push_back(state);
+            result.ids.push_back(boid->ID);
+        }
+    });
+    return result;
+}
+
+template <int Dim>
+BasicBoid<Dim>* BasicFlock<Dim>::nearest(Vec position, float radius) {
+    Boid* result = nullptr;
+    float nearest_distance = radius;
+    for (auto& layer : layers) {
+        for (auto candidate : layer.getPointsWithinRadius(position, radius)) {
+            float distance = magnitude(candidate->get_position() - position);
+            if (distance < nearest_distance) {
+                result = candidate;
+                nearest_distance = distance;
+            }
+        }
+    }
+    return result;
+}
+
+template class BasicFlock<2>;
+template class BasicFlock<3>;
+template CompactSnapshot BasicFlock<2>::snapshot<2, void>(int species_index);
@@ -0,0 +1,101 @@
+//
+// Several species of boid sharing one world. Each species has its own spatial layer, and the interaction
+// matrix says which rules a species applies to the boids of each other species.
+//
+
+#ifndef BOIDS_FLOCK_H
+#define BOIDS_FLOCK_H
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "analytics.h"
+#include "boid.h"
+#include "rule.h"
+#include "scheduler.h"
+#include "include/compact_state.h"
+#include "include/registry.h"
+#include "include/spatial_tree.h"
+
+struct Species
+{
+    Species(std::string p_name, BoidParameters p_params) : name(std::move(p_name)), params(p_params) {}
+    std::string name;
+    BoidParameters params;
+};
+
+/// A world of Dim dimensions spanning [0, extent) along each axis. Flock (2D) uses quadtree layers,
+/// Flock3 (3D) uses octree layers.
+template <int Dim>
+class BasicFlock
+{
+public:
+    using Vec = Vector<Dim>;
+    using Boid = BasicBoid<Dim>;
+    using BoidList = Registry<Boid>;
+    using RuleSet = std::vector<std::unique_ptr<Rule<Dim>>>;
+    using Layer = SpatialTree<Boid*, Dim>;
+
+    explicit BasicFlock(Vec extent);
+    BasicFlock(const BasicFlock&) = delete;
+    BasicFlock& operator = (const BasicFlock&) = delete;
+
+    /// Returns the index used to refer to the new species
+    int add_species(std::string name, BoidParameters params);
+
+    /// Boids of species `who` apply `rule` to the neighbouring boids of species `to`. A species only queries
+    /// the layers of species it has at least one rule for.
+    void add_rule(int who, int to, std::unique_ptr<Rule<Dim>> rule);
+
+    Handle spawn(int species, Vec position, Vec velocity, sf::Color colour);
+    bool despawn(Handle handle);
+
+    /// Rebuilds every species layer from the current boid positions
+    void rebuild_index();
+
+    /// Computes and applies the steering force for every boid, using the layers as last rebuilt
+    void steer();
+
+    /// Moves every boid by one tick
+    void update(sf::Time tick);
+
+    /// Feeds each boid's same-species neighbours to the analytics during steer(). Boids of a species with no
+    /// rules for itself only contribute to their species' polarisation. Pass nullptr to detach.
+    void set_analytics(FlockAnalytics* p_analytics) { analytics = p_analytics; }
+
+    /// Lets the scheduler decide which boids are fully evaluated each frame; the rest keep their last steering
+    /// force. Every boid is evaluated on frames the analytics sample. Pass nullptr to detach.
+    void set_scheduler(BasicUpdateScheduler<Dim>* p_scheduler) { scheduler = p_scheduler; }
+
+    /// Encodes the boids of one species in quantised form, grouped by the leaves of its layer as last rebuilt.
+    /// In debug builds every boid's round trip is checked against the error bounds. 2D only.
+    template <int D = Dim, typename = std::enable_if_t<D == 2>>
+    CompactSnapshot snapshot(int species_index);
+
+    /// Returns the boid of any species nearest to the position, or nullptr if none is within the radius
+    Boid* nearest(Vec position, float radius);
+
+    BoidList& get_boids() { return boids; }
+    const Species& get_species(int index) const { return *species[index]; }
+    std::size_t species_count() const { return species.size(); }
+    Layer& get_layer(int index) { return layers[index]; }
+    Vec get_extent() const { return extent; }
+
+private:
+    Vec extent;
+    BoidList boids;
+    std::vector<std::unique_ptr<Species>> species;
+    std::vector<Layer> layers;
+
+    // interactions[who][to] holds the rules species `who` applies to species `to`
+    std::vector<std::vector<RuleSet>> interactions;
+
+    FlockAnalytics* analytics = nullptr;
+    BasicUpdateScheduler<Dim>* scheduler = nullptr;
+};
+
+using Flock = BasicFlock<2>;
+using Flock3 = BasicFlock<3>;
+
+#endif //BOIDS_FLOCK_H
@@ -0,0 +1,129 @@
+// Quantised boid state for very large flocks and for recordings
+//
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "spatial_tree.h"
+
+/// Position as 16-bit fixed-point offsets within a spatial index cell. The cell bounds are stored once per cell.
+struct CompactPosition {
+    std::uint16_t x;
+    std::uint16_t y;
+};
+
+/// Velocity as a 16-bit heading (in 1/65536ths of a turn) and a 16-bit fraction of the species' max speed
+struct CompactVelocity {
+    std::uint16_t direction;
+    std::uint16_t speed;
+};
+
+struct CompactBoidState {
+    CompactPosition position;
+    CompactVelocity velocity;
+};
+
+static_assert(2 * sizeof(CompactBoidState) == sizeof(sf::Vector2f) + sizeof(sf::Vector2f),
+              "compact state should be half the size of a float position and velocity");
+
+const float COMPACT_STEPS = 65535.0f;
+const float COMPACT_TURN = 65536.0f;
+const float COMPACT_PI = 3.14159265358979323846f;
+
+inline std::uint16_t quantise_unit(float fraction) {
+    return static_cast<std::uint16_t>(std::lround(clamp(fraction, 0.0f, 1.0f) * COMPACT_STEPS));
+}
+
+inline CompactPosition encode_position(sf::Vector2f position, const RectangleBounds& cell) {
+    return CompactPosition{quantise_unit((position.x - cell.min.x) / (cell.max.x - cell.min.x)),
+                           quantise_unit((position.y - cell.min.y) / (cell.max.y - cell.min.y))};
+}
+
+inline sf::Vector2f decode_position(CompactPosition position, const RectangleBounds& cell) {
+    return sf::Vector2f(cell.min.x + position.x / COMPACT_STEPS * (cell.max.x - cell.min.x),
+                        cell.min.y + position.y / COMPACT_STEPS * (cell.max.y - cell.min.y));
+}
+
+/// Speeds above max_speed are clamped to it
+inline CompactVelocity encode_velocity(sf::Vector2f velocity, float max_speed) {
+    float angle = std::atan2(velocity.y, velocity.x);
+    long turns = std::lround(angle / (2 * COMPACT_PI) * COMPACT_TURN);
+    float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    return CompactVelocity{static_cast<std::uint16_t>(turns & 0xffff), quantise_unit(speed / max_speed)};
+}
+
+inline sf::Vector2f decode_velocity(CompactVelocity velocity, float max_speed) {
+    float angle = velocity.direction / COMPACT_TURN * 2 * COMPACT_PI;
+    float speed = velocity.speed / COMPACT_STEPS * max_speed;
+    return sf::Vector2f(speed * std::cos(angle), speed * std::sin(angle));
+}
+
+/// Bound on the distance between a position in the cell and its decoded value: half a step along each axis,
+/// plus float rounding of the absolute coordinates
+inline float max_position_error(const RectangleBounds& cell) {
+    float rounding = 2 * std::numeric_limits<float>::epsilon()
+                     * std::max({std::abs(cell.min.x), std::abs(cell.max.x), std::abs(cell.min.y), std::abs(cell.max.y)});
+    float dx = (cell.max.x - cell.min.x) / COMPACT_STEPS / 2 + rounding;
+    float dy = (cell.max.y - cell.min.y) / COMPACT_STEPS / 2 + rounding;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+/// Bound on the distance between a velocity no faster than max_speed and its decoded value: half a speed step,
+/// plus the chord swept by half a heading step at max speed
+inline float max_velocity_error(float max_speed) {
+    return max_speed / COMPACT_STEPS / 2 + max_speed * COMPACT_PI / COMPACT_TURN;
+}
+
+/// One leaf of the spatial index and the range of states encoded relative to it
+struct CompactCell {
+    RectangleBounds bounds;
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+/// The boids of one species, grouped by quadtree leaf, for recording and for neighbour queries on a recording.
+/// It is a copy built alongside the float state; the step itself still runs on floats. IDs are kept apart from the states so that readers which only
+/// need positions and velocities stream 8 bytes per boid.
+struct CompactSnapshot {
+    float max_speed = 0;
+    std::vector<CompactCell> cells;
+    std::vector<CompactBoidState> states;
+    std::vector<std::int32_t> ids;
+
+    /// Writes the snapshot as raw records in host byte order: max speed, cell count, cells, state count, states, IDs
+    void write(std::ostream& os) const {
+        auto cell_count = static_cast<std::uint32_t>(cells.size());
+        auto state_count = static_cast<std::uint32_t>(states.size());
+        os.write(reinterpret_cast<const char*>(&max_speed), sizeof(max_speed));
+        os.write(reinterpret_cast<const char*>(&cell_count), sizeof(cell_count));
+        os.write(reinterpret_cast<const char*>(cells.data()), cells.size() * sizeof(CompactCell));
+        os.write(reinterpret_cast<const char*>(&state_count), sizeof(state_count));
+        os.write(reinterpret_cast<const char*>(states.data()), states.size() * sizeof(CompactBoidState));
+        os.write(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(std::int32_t));
+    }
+
+    /// IDs of the boids whose decoded position is strictly within the radius of the centre. Cells that don't
+    /// intersect the circle are skipped without touching their states; the rest are streamed 8 bytes per boid.
+    /// Compared with a query on the float state, boids within max_position_error of the edge may differ.
+    std::vector<std::int32_t> ids_within_radius(sf::Vector2f centre, float radius) const {
+        std::vector<std::int32_t> result;
+        for (const auto& cell : cells) {
+            float dx = centre.x - clamp(centre.x, cell.bounds.min.x, cell.bounds.max.x);
+            float dy = centre.y - clamp(centre.y, cell.bounds.min.y, cell.bounds.max.y);
+            if (dx * dx + dy * dy >= radius * radius) continue;
+            for (std::uint32_t i = cell.first; i < cell.first + cell.count; ++i) {
+                sf::Vector2f offset = decode_position(states[i].position, cell.bounds) - centre;
+                if (offset.x * offset.x + offset.y * offset.y < radius * radius) {
+                    result.push_back(ids[i]);
+                }
+            }
+        }
+        return result;
+    }
+};
@@ -0,0 +1,121 @@
+// Dense storage for live simulation objects with stable IDs and O(1) spawn / despawn
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// Refers to an item in a Registry. The generation is bumped every time a slot is freed, so a handle to a
+/// despawned item never aliases whatever later reuses its slot.
+struct Handle {
+    static constexpr std::uint32_t INVALID = 0xffffffff;
+
+    std::uint32_t index = INVALID;
+    std::uint32_t generation = 0;
+
+    bool operator == (const Handle &rhs) const {
+        return index == rhs.index and generation == rhs.generation;
+    }
+
+    bool operator != (const Handle &rhs) const {
+        return not (*this == rhs);
+    }
+};
+
+/// Owns a set of items, packed contiguously for iteration. Removal swaps the last item into the gap, and freed
+/// slots are recycled through a free list, so spawn and despawn are both O(1). Each item is constructed with its
+/// slot index as its final constructor argument; this ID is stable for the item's lifetime and unique among live
+/// items, but may be reused after the item is despawned (use a Handle to detect this).
+template <typename T>
+class Registry {
+public:
+    using Hook = std::function<void(T*)>;
+    using iterator = typename std::vector<std::unique_ptr<T>>::iterator;
+
+    template <typename... Args>
+    Handle spawn(Args&&... args) {
+        std::uint32_t index;
+        if (not freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        slots[index].dense = static_cast<std::uint32_t>(items.size());
+        items.push_back(std::make_unique<T>(std::forward<Args>(args)..., static_cast<int>(index)));
+        denseToSlot.push_back(index);
+        if (spawnHook) spawnHook(items.back().get());
+        return Handle{index, slots[index].generation};
+    }
+
+    /// Removes the item referred to by the handle. Returns false if the handle is stale.
+    /// Invalidates iterators, so don't call this while looping over the registry.
+    bool despawn(Handle handle) {
+        if (not contains(handle)) return false;
+        std::uint32_t dense = slots[handle.index].dense;
+        if (despawnHook) despawnHook(items[dense].get());
+
+        std::uint32_t last = static_cast<std::uint32_t>(items.size()) - 1;
+        if (dense != last) {
+            items[dense] = std::move(items[last]);
+            denseToSlot[dense] = denseToSlot[last];
+            slots[denseToSlot[dense]].dense = dense;
+        }
+        items.pop_back();
+        denseToSlot.pop_back();
+
+        slots[handle.index].dense = Handle::INVALID;
+        slots[handle.index].generation++;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    bool contains(Handle handle) const {
+        return handle.index < slots.size()
+               and slots[handle.index].generation == handle.generation
+               and slots[handle.index].dense != Handle::INVALID;
+    }
+
+    /// Returns the item referred to by the handle, or nullptr if it has been despawned
+    T* get(Handle handle) const {
+        return contains(handle) ? items[slots[handle.index].dense].get() : nullptr;
+    }
+
+    /// Returns a handle to a live item
+    Handle handle_of(const T& item) const {
+        auto index = static_cast<std::uint32_t>(item.ID);
+        return Handle{index, slots[index].generation};
+    }
+
+    /// Called after an item is spawned, and before an item is despawned, so spatial indices can be kept in sync
+    void on_spawn(Hook hook) { spawnHook = std::move(hook); }
+    void on_despawn(Hook hook) { despawnHook = std::move(hook); }
+
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    /// Upper bound (exclusive) on the IDs of live items
+    std::size_t capacity() const { return slots.size(); }
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+
+private:
+    struct Slot {
+        std::uint32_t dense = Handle::INVALID;
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<std::unique_ptr<T>> items;
+    std::vector<std::uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+
+    Hook spawnHook;
+    Hook despawnHook;
+};
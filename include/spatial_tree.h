@@ -0,0 +1,246 @@
+//
+// Created by Kevin Gori on 07/03/2021.
+//
+
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+#include "../vector_utils.h"
+
+/// Axis-aligned box: a rectangle in 2D, a cuboid in 3D
+template <int Dim>
+struct Bounds {
+    Bounds(Vector<Dim> min_, Vector<Dim> max_) : min(min_), max(max_) {}
+    Vector<Dim> min;
+    Vector<Dim> max;
+};
+
+using RectangleBounds = Bounds<2>;
+using BoxBounds = Bounds<3>;
+
+inline float clamp(float x, float min, float max) {
+    if (x < min) return min;
+    if (x > max) return max;
+    return x;
+}
+
+/// Bucketed spatial tree that splits each full node into 2^Dim equal children: a quadtree in 2D, an octree in 3D.
+/// Child i covers the upper half of axis a if bit a of i is set, so in 2D the children are ordered
+/// top-left, top-right, bottom-left, bottom-right. Nodes at MAX_DEPTH never split and hold any number of items,
+/// so items at the same position can't recurse forever.
+template <typename T, int Dim>
+class SpatialTree {
+public:
+    static constexpr int NCHILDREN = 1 << Dim;
+    static constexpr int MAX_DEPTH = 16;
+    using Vec = Vector<Dim>;
+
+    SpatialTree(Vec min_, Vec max_, int depth_ = 0) : bounds(min_, max_), depth(depth_) {}
+
+    void add(T item) {
+        if (not isLeaf()) {
+            addToChild(item);
+        }
+        else {
+            if (items.size() < 4 or depth >= MAX_DEPTH) {
+                items.push_back(item);
+            }
+            else {
+                initialiseChildren();
+                for (auto& existingItem : items) {
+                    addToChild(existingItem);
+                }
+                items.clear();
+                addToChild(item);
+            }
+        }
+    }
+
+    /// Removes an item. Looks in the leaf for the item's current position first, and falls back to searching the
+    /// whole tree if the item has moved since it was added. Returns false if the item isn't in the tree.
+    /// Empty children are not collapsed; the tree is expected to be rebuilt every frame.
+    bool remove(const T& item) {
+        return removeFromLeafContaining(item, item->get_position()) or removeFromAnyLeaf(item);
+    }
+
+    /// Empties the tree, keeping its bounds
+    void clear() {
+        for (auto& child : children) {
+            child.reset();
+        }
+        items.clear();
+    }
+
+    float getSize(int axis) { return component(bounds.max, axis) - component(bounds.min, axis); }
+    float getWidth() { return getSize(0); }
+    float getHeight() { return getSize(1); }
+    Bounds<Dim> getBounds() { return bounds; }
+
+    std::vector<Bounds<Dim>> getAllBounds() {
+        std::vector<Bounds<Dim>> output;
+        pushBounds(output);
+        return output;
+    }
+
+    std::vector<Bounds<Dim>> getIntersectingBounds(Vec centre, float r) {
+        std::vector<Bounds<Dim>> output;
+        pushBounds(output, centre, r);
+        return output;
+    }
+
+    /// Recursively fetches all points at this node and below that fall within the circle (or sphere)
+    /// with the given centre and radius
+    std::vector<T> getPointsWithinRadius(Vec centre, float radius) {
+        std::vector<T> result;
+        accumulatePointsWithinRadius(result, centre, radius);
+        return result;
+    }
+
+    /// Calls f(bounds, items) for every leaf, in depth-first order
+    template <typename F>
+    void forEachLeaf(F&& f) {
+        if (isLeaf()) {
+            f(getBounds(), static_cast<const std::vector<T>&>(items));
+        }
+        else {
+            for (auto& child : children) {
+                child->forEachLeaf(f);
+            }
+        }
+    }
+
+    /// Checks if this node's bounds intersect the circle (or sphere) with the given centre and radius
+    bool intersectsRadius(Vec centre, float radius) {
+        float distanceSquared = 0;
+        for (int axis = 0; axis < Dim; ++axis) {
+            float c = component(centre, axis);
+            float distance = c - clamp(c, component(bounds.min, axis), component(bounds.max, axis));
+            distanceSquared += distance * distance;
+        }
+        return distanceSquared < radius * radius;
+    }
+
+private:
+
+    Bounds<Dim> bounds;
+    int depth;
+
+    // Children
+    std::array<std::unique_ptr<SpatialTree>, NCHILDREN> children;
+
+    // Contents
+    std::vector<T> items;
+
+    bool isLeaf() { return children[0] == nullptr; }
+
+    void initialiseChildren() {
+        Vec mid = (bounds.min + bounds.max) / 2.0f;
+        for (int i = 0; i < NCHILDREN; ++i) {
+            Vec childMin = bounds.min;
+            Vec childMax = mid;
+            for (int axis = 0; axis < Dim; ++axis) {
+                if (i & (1 << axis)) {
+                    component(childMin, axis) = component(mid, axis);
+                    component(childMax, axis) = component(bounds.max, axis);
+                }
+            }
+            children[i] = std::make_unique<SpatialTree>(childMin, childMax, depth + 1);
+        }
+    }
+
+    SpatialTree& childContaining(Vec position) {
+        int index = 0;
+        for (int axis = 0; axis < Dim; ++axis) {
+            float mid = (component(bounds.min, axis) + component(bounds.max, axis)) / 2;
+            if (not (component(position, axis) < mid)) {
+                index |= 1 << axis;
+            }
+        }
+        return *children[index];
+    }
+
+    bool removeFromLeaf(const T& item) {
+        for (auto& existingItem : items) {
+            if (existingItem == item) {
+                existingItem = items.back();
+                items.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool removeFromLeafContaining(const T& item, Vec position) {
+        if (isLeaf()) {
+            return removeFromLeaf(item);
+        }
+        return childContaining(position).removeFromLeafContaining(item, position);
+    }
+
+    bool removeFromAnyLeaf(const T& item) {
+        if (isLeaf()) {
+            return removeFromLeaf(item);
+        }
+        for (auto& child : children) {
+            if (child->removeFromAnyLeaf(item)) return true;
+        }
+        return false;
+    }
+
+    void addToChild(T& item) {
+        childContaining(item->get_position()).add(item);
+    }
+
+    void pushBounds(std::vector<Bounds<Dim>>& acc) {
+        if (isLeaf()) {
+            acc.push_back(getBounds());
+        }
+        else {
+            for (auto& child : children) {
+                child->pushBounds(acc);
+            }
+        }
+    }
+
+    void accumulatePointsWithinRadius(std::vector<T>& acc, Vec centre, float radius) {
+        if (isLeaf()) {
+            if (intersectsRadius(centre, radius)) {
+                for (auto& point : items) {
+                    Vec offset = point->get_position() - centre;
+                    float distanceSquared = 0;
+                    for (int axis = 0; axis < Dim; ++axis) {
+                        distanceSquared += component(offset, axis) * component(offset, axis);
+                    }
+                    if (distanceSquared < radius * radius) {
+                        acc.push_back(point);
+                    }
+                }
+            }
+        }
+        else {
+            for (auto& child : children) {
+                child->accumulatePointsWithinRadius(acc, centre, radius);
+            }
+        }
+    }
+
+    void pushBounds(std::vector<Bounds<Dim>>& acc, Vec centre, float r) {
+        if (isLeaf()) {
+            if (intersectsRadius(centre, r)) {
+                acc.push_back(getBounds());
+            }
+        }
+        else {
+            for (auto& child : children) {
+                child->pushBounds(acc, centre, r);
+            }
+        }
+    }
+};
+
+template <typename T>
+using Quadtree = SpatialTree<T, 2>;
+
+template <typename T>
+using Octree = SpatialTree<T, 3>;
@@ -1,17 +1,20 @@
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <random>
+#include "analytics.h"
 #include "boid.h"
+#include "flock.h"
 #include "rule.h"
+#include "scheduler.h"
 #include "vector_utils.h"
 #include "include/random.h"
-#include "include/quadtree.h"
-
-using BoidList = std::vector<std::unique_ptr<Boid>>;
+#include "include/registry.h"
+#include "include/spatial_tree.h"
 
 
 const int NBOIDS = 200;
@@ -28,10 +31,27 @@ const float COHES_WT = 0.9;
 const float SEPAR_WT = 2.0;
 const float BOUND_WT = 1.0;
 
+const int NPREDATORS = 3;
+const int PREDATOR_HEIGHT = 20;
+const int PREDATOR_WIDTH = 12;
+const int PREDATOR_MAX_SPEED = 170;
+const int PREDATOR_MAX_FORCE = 200;
+const int PREDATOR_PERCEPTION_RADIUS = 200;
+const int PREDATOR_SEPARATION_RADIUS = 150;
+const sf::Color PREDATOR_COLOUR = sf::Color(200, 40, 40);
+const float CHASE_WT = 3.0;
+const float FLEE_WT = 8.0;
+
+const int ANALYTICS_INTERVAL = 120;  // frames between flock metrics reports
+const float LOD_ERROR_TOLERANCE = 0.5;  // pixels of drift allowed between full boid updates
+
 
 #undef DEBUG_SHOW_BOID_FORCES
 #undef DEBUG_SHOW_BOID_AWARENESS_RADII
 #define DEBUG_SHOW_QUADTREE
+#define SHOW_FLOCK_METRICS
+#undef RECORD_COMPACT_SNAPSHOTS
+#define ADAPTIVE_UPDATE_RATES
 
 int main() {
     RandomVector2fGenerator rg;
@@ -41,16 +61,23 @@ int main() {
     sf::RenderWindow window(sf::VideoMode(1920, 1080), "Boids!");
     window.setVerticalSyncEnabled(true);
 
-    // Generates NBOIDS boids at random positions on the screen, and with a small random initial velocity
-    BoidList boids;
+    Flock flock(sf::Vector2f(1920, 1080));
+    int prey = flock.add_species("Prey", BoidParameters{BOID_MAX_SPEED, BOID_MAX_FORCE, BOID_PERCEPTION_RADIUS,
+                                                       BOID_HEIGHT, BOID_WIDTH});
+    int predator = flock.add_species("Predator", BoidParameters{PREDATOR_MAX_SPEED, PREDATOR_MAX_FORCE,
+                                                               PREDATOR_PERCEPTION_RADIUS,
+                                                               PREDATOR_HEIGHT, PREDATOR_WIDTH});
 
+    // Generates NBOIDS boids at random positions on the screen, and with a small random initial velocity
     for (int i = 0; i < NBOIDS; ++i) {
         auto pos = rg.generate(0, 1920, 0, 1080);
         auto vel = rg.generate(-1, 1, -1, 1);
-        auto boid = std::make_unique<Boid>(pos, normalise(vel) * 20.f,
-                           BOID_MAX_SPEED, BOID_MAX_FORCE, BOID_PERCEPTION_RADIUS,
-                           BOID_HEIGHT, BOID_WIDTH, rc.generate(), i);
-        boids.push_back(std::move(boid));
+        flock.spawn(prey, pos, normalise(vel) * 20.f, rc.generate());
+    }
+    for (int i = 0; i < NPREDATORS; ++i) {
+        auto pos = rg.generate(0, 1920, 0, 1080);
+        auto vel = rg.generate(-1, 1, -1, 1);
+        flock.spawn(predator, pos, normalise(vel) * 20.f, PREDATOR_COLOUR);
     }
 
     sf::Clock clock;
@@ -63,34 +90,66 @@ int main() {
     music.setLoop(true);
     music.play();
 
-    std::vector<std::unique_ptr<Rule>> rules;
-    rules.push_back(std::make_unique<Accelerate>(ACCEL_WT));
-    rules.push_back(std::make_unique<Alignment>(ALIGN_WT));
-    rules.push_back(std::make_unique<Cohesion>(COHES_WT));
-    rules.push_back(std::make_unique<Separation>(BOID_SEPARATION_RADIUS, SEPAR_WT));
-//    rules.push_back(std::make_unique<BoundingBox>(
+    flock.add_rule(prey, prey, std::make_unique<Accelerate<2>>(ACCEL_WT));
+    flock.add_rule(prey, prey, std::make_unique<Alignment<2>>(ALIGN_WT));
+    flock.add_rule(prey, prey, std::make_unique<Cohesion<2>>(COHES_WT));
+    flock.add_rule(prey, prey, std::make_unique<Separation<2>>(BOID_SEPARATION_RADIUS, SEPAR_WT));
+//    flock.add_rule(prey, prey, std::make_unique<BoundingBox<2>>(
 //            sf::Vector2f(100, 100),
 //            sf::Vector2f(1820, 980),
 //            50, BOUND_WT));
+    flock.add_rule(prey, predator, std::make_unique<Separation<2>>(BOID_PERCEPTION_RADIUS, FLEE_WT));
+    flock.add_rule(predator, prey, std::make_unique<Cohesion<2>>(CHASE_WT));
+    flock.add_rule(predator, predator, std::make_unique<Separation<2>>(PREDATOR_SEPARATION_RADIUS, SEPAR_WT));
+
+#ifdef SHOW_FLOCK_METRICS
+    FlockAnalytics analytics(ANALYTICS_INTERVAL);
+    flock.set_analytics(&analytics);
+#endif
+
+#ifdef ADAPTIVE_UPDATE_RATES
+    // Press F to toggle full updates every frame, to compare against the extrapolated boids
+    SchedulerSettings lod_settings;
+    lod_settings.error_tolerance = LOD_ERROR_TOLERANCE;
+    UpdateScheduler scheduler(lod_settings);
+    scheduler.set_viewport(RectangleBounds(sf::Vector2f(0, 0), sf::Vector2f(1920, 1080)));
+    flock.set_scheduler(&scheduler);
+#endif
+
+#ifdef RECORD_COMPACT_SNAPSHOTS
+    std::ofstream recording("boids.rec", std::ios::binary);
+#endif
 
     while (window.isOpen()) {
+        // Add all boids to their species' quadtree
+        flock.rebuild_index();
+
         // check all the window's events that were triggered since the last iteration of the loop
         sf::Event event;
         while (window.pollEvent(event)) {
             // "close requested" event: we close the window
             if (event.type == sf::Event::Closed)
                 window.close();
+#ifdef ADAPTIVE_UPDATE_RATES
+            if (event.type == sf::Event::KeyPressed and event.key.code == sf::Keyboard::F)
+                scheduler.settings.force_full_updates = not scheduler.settings.force_full_updates;
+#endif
             if (event.type == sf::Event::MouseButtonPressed)
             {
                 if (event.mouseButton.button == sf::Mouse::Left)
                 {
-                    int id = !boids.empty() ? boids.back()->ID + 1 : 1;
                     sf::Vector2f pos(event.mouseButton.x, event.mouseButton.y);
                     sf::Vector2f vel = rg.generate(-1, 1, -1, 1);
-                    auto boid = std::make_unique<Boid>(pos, normalise(vel) * 50.f,
-                                       BOID_MAX_SPEED, BOID_MAX_FORCE, BOID_PERCEPTION_RADIUS,
-                                       BOID_HEIGHT, BOID_WIDTH, rc.generate(), id);
-                    boids.push_back(std::move(boid));
+                    flock.spawn(prey, pos, normalise(vel) * 50.f, rc.generate());
+                }
+                if (event.mouseButton.button == sf::Mouse::Right)
+                {
+                    // Despawn the boid nearest the click, if there is one within perception range
+                    sf::Vector2f pos(event.mouseButton.x, event.mouseButton.y);
+                    Boid* nearest = flock.nearest(pos, BOID_PERCEPTION_RADIUS);
+                    if (nearest != nullptr) {
+                        flock.despawn(flock.get_boids().handle_of(*nearest));
+                    }
                 }
             }
         }
@@ -100,28 +159,27 @@ int main() {
 
         window.clear(sf::Color(235, 230, 225));
 
-        // Add all boids to quadtree
-        Quadtree<Boid*> quadtree(0, 1920, 0, 1080);
-        for (auto& boid : boids) {
-            quadtree.add(boid.get());
+        flock.steer();
+
+#ifdef RECORD_COMPACT_SNAPSHOTS
+        for (std::size_t species = 0; species < flock.species_count(); ++species) {
+            flock.snapshot(species).write(recording);
         }
+#endif
 
-        for (auto & boid : boids) {
-            sf::Vector2f resultant_force(0, 0);
-            auto boidPos = boid->get_position();
-            auto neighbours = quadtree.getPointsWithinCircle(boidPos.x, boidPos.y, BOID_PERCEPTION_RADIUS);
-            for (auto &rule : rules) {
-                sf::Vector2f force_added = normalise(rule->apply_rule(*boid, neighbours)) * rule->weight;
-                resultant_force += force_added;
-            }
-            resultant_force = normalise(resultant_force);
-            boid->apply_force(resultant_force);
+#ifdef SHOW_FLOCK_METRICS
+        if (analytics.published()) {
+            std::cout << analytics.latest() << std::endl;
+        }
+#endif
 
 #ifdef DEBUG_SHOW_BOID_FORCES
+        for (auto & boid : flock.get_boids()) {
+            sf::Vector2f resultant_force = normalise(boid->get_acceleration());
             sf::Vertex line[] =
             {
                 sf::Vertex(boid->get_position()),
-                sf::Vertex(boid->get_position() + resultant_force * 0.5f * (float)BOID_PERCEPTION_RADIUS)
+                sf::Vertex(boid->get_position() + resultant_force * 0.5f * boid->params->perception)
             };
             line[0].color = sf::Color::Black;
             line[1].color = sf::Color::Black;
@@ -134,16 +192,16 @@ int main() {
             velocity_line[0].color = sf::Color::Red;
             velocity_line[1].color = sf::Color::Red;
             window.draw(velocity_line, 2, sf::Lines);
-#endif
-
         }
+#endif
 
-        for (auto & boid : boids) {
-            boid->update(dt);
+        flock.update(dt);
+        for (auto & boid : flock.get_boids()) {
             window.draw(boid->get_drawable());
 #ifdef DEBUG_SHOW_BOID_AWARENESS_RADII
-            sf::CircleShape circle(BOID_PERCEPTION_RADIUS*0.5f);
-            circle.setPosition(boid->get_position() - 0.5f*sf::Vector2f(BOID_PERCEPTION_RADIUS, BOID_PERCEPTION_RADIUS));
+            float perception = boid->params->perception;
+            sf::CircleShape circle(perception*0.5f);
+            circle.setPosition(boid->get_position() - 0.5f*sf::Vector2f(perception, perception));
             circle.setFillColor(sf::Color::Transparent);
             circle.setOutlineColor(sf::Color(240.0f, 20.0f, 20.0f, 60.0f));
             circle.setOutlineThickness(1.0);
@@ -156,9 +214,9 @@ int main() {
 
 
 #ifdef DEBUG_SHOW_QUADTREE
-        for (auto bounds : quadtree.getAllRectangleBounds()) {
-            sf::RectangleShape newRectangle(sf::Vector2f(bounds.xmax - bounds.xmin, bounds.ymax - bounds.ymin));
-            newRectangle.setPosition(bounds.xmin, bounds.ymin);
+        for (auto bounds : flock.get_layer(prey).getAllBounds()) {
+            sf::RectangleShape newRectangle(bounds.max - bounds.min);
+            newRectangle.setPosition(bounds.min);
             newRectangle.setFillColor(sf::Color::Transparent);
             newRectangle.setOutlineColor(sf::Color::Green);
             newRectangle.setOutlineThickness(1);
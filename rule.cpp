@@ -6,22 +6,24 @@
 #include "rule.h"
 #include "vector_utils.h"
 
-sf::Vector2f get_acceleration_towards_position(const Boid& b, sf::Vector2f target) {
+template <int Dim>
+Vector<Dim> get_acceleration_towards_position(const BasicBoid<Dim>& b, Vector<Dim> target) {
     auto current_location = b.get_position();
     auto current_velocity = b.get_velocity();
-    sf::Vector2f acceleration = target - current_location - current_velocity;
+    Vector<Dim> acceleration = target - current_location - current_velocity;
 
     return magnitude(acceleration) > 0 ? normalise(acceleration) : acceleration;
 }
 
-sf::Vector2f Cohesion::apply_rule(Boid b, const std::vector<Boid*>& boids) {
-    sf::Vector2f steering(0, 0);
-    sf::Vector2f centre_of_mass(0, 0);
+template <int Dim>
+auto Cohesion<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
+    Vec steering;
+    Vec centre_of_mass;
     float N = 0.0f;
 
     for (const auto& boid : boids) {
         if (b.ID == boid->ID) continue;
-        if (magnitude(boid->get_position() - b.get_position()) < b.perception) {
+        if (magnitude(boid->get_position() - b.get_position()) < b.params->perception) {
             centre_of_mass += boid->get_position();
             N++;
         }
@@ -33,9 +35,10 @@ sf::Vector2f Cohesion::apply_rule(Boid b, const std::vector<Boid*>& boids) {
     return steering;
 }
 
-sf::Vector2f Separation::apply_rule(Boid me, const std::vector<Boid*>& boids) {
-    sf::Vector2f target = me.get_position();
-    sf::Vector2f direction_to_move;
+template <int Dim>
+auto Separation<Dim>::apply_rule(Boid me, const std::vector<Boid*>& boids) -> Vec {
+    Vec target = me.get_position();
+    Vec direction_to_move;
     bool rule_activated = false;
     for (const auto& neighbour : boids) {
         if (neighbour->ID == me.ID) continue;
@@ -47,16 +50,17 @@ sf::Vector2f Separation::apply_rule(Boid me, const std::vector<Boid*>& boids) {
             target += direction_to_move * distance_to_move;
         }
     }
-    return rule_activated ? get_acceleration_towards_position(me, target) : sf::Vector2f(0, 0);
+    return rule_activated ? get_acceleration_towards_position(me, target) : Vec();
 }
 
-sf::Vector2f Alignment::apply_rule(Boid b, const std::vector<Boid*>& boids) {
-    sf::Vector2f average_velocity(0, 0);
+template <int Dim>
+auto Alignment<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
+    Vec average_velocity;
     float N = 0;
     for (const auto& boid : boids) {
         //if (boid->ID == b.ID) continue;
         float distance = magnitude(boid->get_position() - b.get_position());
-        if (distance < b.perception) {
+        if (distance < b.params->perception) {
             average_velocity += boid->get_velocity();
             N += 1;
         }
@@ -67,49 +71,75 @@ sf::Vector2f Alignment::apply_rule(Boid b, const std::vector<Boid*>& boids) {
         auto steer = average_velocity;// - b.get_velocity();
         return normalise(steer);
     }
-    return sf::Vector2f(0, 0);
+    return Vec();
 
 }
 
-sf::Vector2f Seek::apply_rule(Boid b, const std::vector<Boid*>& boids) {
+template <int Dim>
+auto Seek<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
     return get_acceleration_towards_position(b, this->target);
 }
 
-sf::Vector2f Accelerate::apply_rule(Boid b, const std::vector<Boid*>& boids) {
+template <int Dim>
+auto Accelerate<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
     int N = 0;
     for (const auto& boid : boids) {
         if (boid->ID == b.ID) continue;
         float distance = magnitude(boid->get_position() - b.get_position());
-        if (distance < b.perception) {
+        if (distance < b.params->perception) {
             N++;
         }
     }
-    return N == 0 ? normalise(b.get_velocity()) : sf::Vector2f(0.0f, 0.0f);
+    return N == 0 ? normalise(b.get_velocity()) : Vec();
 }
 
-sf::Vector2f BoundingBox::apply_rule(Boid b, const std::vector<Boid*>& boids) {
-    float x_repulsion = (b.get_position().x - topleft.x) < area_of_effect ?
-            area_of_effect - (b.get_position().x - topleft.x) : 0;
-    x_repulsion += (bottomright.x - b.get_position().x) < area_of_effect ?
-            bottomright.x - b.get_position().x - area_of_effect : 0;
-    float y_repulsion = (b.get_position().y - topleft.y) < area_of_effect ?
-                        area_of_effect - (b.get_position().y - topleft.y) : 0;
-    y_repulsion += (bottomright.y - b.get_position().y) < area_of_effect ?
-                   bottomright.y - b.get_position().y - area_of_effect : 0;
-    sf::Vector2f force(x_repulsion, y_repulsion);
+template <int Dim>
+auto BoundingBox<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
+    Vec force;
+    for (int axis = 0; axis < Dim; ++axis) {
+        float position = component(b.get_position(), axis);
+        float low = component(topleft, axis);
+        float high = component(bottomright, axis);
+        float repulsion = (position - low) < area_of_effect ?
+                area_of_effect - (position - low) : 0;
+        repulsion += (high - position) < area_of_effect ?
+                high - position - area_of_effect : 0;
+        component(force, axis) = repulsion;
+    }
     return force;
 }
 
-sf::Vector2f Avoid::apply_rule(Boid b, const std::vector<Boid*>& boids) {
+template <int Dim>
+auto Avoid<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
     float distance = magnitude((b.get_position() - target));
     return -get_acceleration_towards_position(b, this->target) / (distance * distance);
 }
 
-sf::Vector2f Gravity::apply_rule(Boid b, const std::vector<Boid *> &boids) {
+template <int Dim>
+auto Gravity<Dim>::apply_rule(Boid b, const std::vector<Boid*>& boids) -> Vec {
     auto pos = b.get_position();
     if (pos.y < ground) {
-        return get_acceleration_towards_position(b, sf::Vector2f(pos.x, ground));
+        Vec target = pos;
+        target.y = ground;
+        return get_acceleration_towards_position(b, target);
     }
-    return sf::Vector2f(0.0f, 0.0f);
+    return Vec();
 }
 
+template struct Cohesion<2>;
+template struct Separation<2>;
+template struct Alignment<2>;
+template struct Accelerate<2>;
+template struct Seek<2>;
+template struct Avoid<2>;
+template struct BoundingBox<2>;
+template struct Gravity<2>;
+
+template struct Cohesion<3>;
+template struct Separation<3>;
+template struct Alignment<3>;
+template struct Accelerate<3>;
+template struct Seek<3>;
+template struct Avoid<3>;
+template struct BoundingBox<3>;
+template struct Gravity<3>;
@@ -8,74 +8,104 @@
 #include <vector>
 #include "boid.h"
 
+template <int Dim>
 struct Rule
 {
+    using Vec = Vector<Dim>;
+    using Boid = BasicBoid<Dim>;
+
     Rule(float p_weight) : weight(p_weight) {}
-    virtual sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) = 0;
+    virtual Vec apply_rule(Boid b, const std::vector<Boid*>& boids) = 0;
     virtual ~Rule() = default;
     virtual std::string get_name() = 0;
     float weight;
 };
 
-struct Cohesion : Rule
+template <int Dim>
+struct Cohesion : Rule<Dim>
 {
-    Cohesion(float p_weight) : Rule(p_weight) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Cohesion(float p_weight) : Rule<Dim>(p_weight) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
     std::string get_name() override { return std::string("Cohesion"); };
 };
 
-struct Separation : Rule
+template <int Dim>
+struct Separation : Rule<Dim>
 {
-    Separation(float sep, float p_weight) : Rule(p_weight), separation_threshold(sep) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Separation(float sep, float p_weight) : Rule<Dim>(p_weight), separation_threshold(sep) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
     float separation_threshold;
     std::string get_name() override { return std::string("Separation"); };
 };
 
-struct Alignment : Rule
+template <int Dim>
+struct Alignment : Rule<Dim>
 {
-    Alignment(float p_weight) : Rule(p_weight) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Alignment(float p_weight) : Rule<Dim>(p_weight) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
     std::string get_name() override { return std::string("Alignment"); };
 };
 
-struct Accelerate : Rule
+template <int Dim>
+struct Accelerate : Rule<Dim>
 {
-    Accelerate(float p_weight) :  Rule(p_weight) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Accelerate(float p_weight) :  Rule<Dim>(p_weight) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
     std::string get_name() override { return std::string("Accelerate"); };
 };
 
-struct Seek : Rule
+template <int Dim>
+struct Seek : Rule<Dim>
 {
-    Seek(sf::Vector2f point, float p_weight) : Rule(p_weight), target(point) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
-    sf::Vector2f target;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Seek(Vec point, float p_weight) : Rule<Dim>(p_weight), target(point) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    Vec target;
     std::string get_name() override { return std::string("Seek"); };
 };
 
-struct Avoid : Rule
+template <int Dim>
+struct Avoid : Rule<Dim>
 {
-    Avoid(sf::Vector2f point, float p_weight) :  Rule(p_weight), target(point) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
-    sf::Vector2f target;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Avoid(Vec point, float p_weight) :  Rule<Dim>(p_weight), target(point) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    Vec target;
     std::string get_name() override { return std::string("Avoid"); };
 };
 
-struct BoundingBox : Rule
+/// Pushes boids back inside the box spanned by `topleft` (the minimum corner) and `bottomright` (the maximum)
+template <int Dim>
+struct BoundingBox : Rule<Dim>
 {
-    BoundingBox(sf::Vector2f p_topleft, sf::Vector2f p_bottomright, float p_area, float p_weight)
-    :  Rule(p_weight), topleft(p_topleft), bottomright(p_bottomright), area_of_effect(p_area){}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
-    sf::Vector2f topleft, bottomright;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    BoundingBox(Vec p_topleft, Vec p_bottomright, float p_area, float p_weight)
+    :  Rule<Dim>(p_weight), topleft(p_topleft), bottomright(p_bottomright), area_of_effect(p_area){}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    Vec topleft, bottomright;
     float area_of_effect;
     std::string get_name() override { return std::string("BoundingBox"); };
 };
 
-struct Gravity : Rule
+/// Pulls boids down the y axis towards `ground`
+template <int Dim>
+struct Gravity : Rule<Dim>
 {
-    Gravity(float ground, float p_weight) : Rule(p_weight), ground(ground) {}
-    sf::Vector2f apply_rule(Boid b, const std::vector<Boid*>& boids) override;
+    using typename Rule<Dim>::Vec;
+    using typename Rule<Dim>::Boid;
+    Gravity(float ground, float p_weight) : Rule<Dim>(p_weight), ground(ground) {}
+    Vec apply_rule(Boid b, const std::vector<Boid*>& boids) override;
     float ground;
     std::string get_name() override { return std::string("Gravity"); };
 };
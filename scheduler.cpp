@@ -0,0 +1,106 @@
+//
+// Temporal level of detail
+//
+
+#include <algorithm>
+#include <cmath>
+#include "scheduler.h"
+#include "vector_utils.h"
+
+template <int Dim>
+void BasicUpdateScheduler<Dim>::set_viewport(Bounds<Dim> p_viewport) {
+    viewport = p_viewport;
+    has_viewport = true;
+}
+
+template <int Dim>
+void BasicUpdateScheduler<Dim>::reset(int id) {
+    schedule_for(id) = BoidSchedule();
+}
+
+template <int Dim>
+bool BasicUpdateScheduler<Dim>::due(const Boid& boid) const {
+    if (settings.force_full_updates) return true;
+    auto id = static_cast<std::size_t>(boid.ID);
+    return id >= schedules.size() or not schedules[id].evaluated or schedules[id].next_frame <= frame;
+}
+
+template <int Dim>
+auto BasicUpdateScheduler<Dim>::extrapolate(const Boid& boid) -> Vec {
+    extrapolated_count++;
+    return schedules[boid.ID].force;
+}
+
+template <int Dim>
+void BasicUpdateScheduler<Dim>::record(const Boid& boid, Vec force, std::size_t neighbour_count,
+                                       std::uint32_t neighbour_signature) {
+    full_count++;
+    auto& schedule = schedule_for(boid.ID);
+
+    int interval = 1;
+    if (schedule.evaluated) {
+        // Activity per frame since the last evaluation, which may have been early (forced or analytics frames):
+        // how far the (unit) steering force turned, and the fraction of the neighbourhood that changed
+        float force_change = magnitude(force - schedule.force);
+        float neighbourhood = std::max<std::size_t>({neighbour_count, schedule.neighbours, 1});
+        float neighbour_change = std::abs(static_cast<float>(neighbour_count) - schedule.neighbours) / neighbourhood;
+        if (neighbour_signature != schedule.signature) {
+            neighbour_change = std::max(neighbour_change, 1 / neighbourhood);
+        }
+        auto elapsed = std::max<unsigned long>(frame - schedule.last_evaluated_frame, 1);
+        float rate = std::max(force_change, neighbour_change) / elapsed;
+
+        float distance = distance_from_viewport(boid.get_position());
+        float tolerance = settings.error_tolerance * (1 + distance / settings.viewport_falloff);
+        int max_interval = distance > 0 ? settings.max_offscreen_interval : settings.max_interval;
+
+        float drift_per_frame_cubed = boid.params->max_force * rate * tick_seconds * tick_seconds / 6;
+        if (drift_per_frame_cubed > 0) {
+            interval = static_cast<int>(std::cbrt(tolerance / drift_per_frame_cubed));
+        }
+        else {
+            interval = max_interval;
+        }
+        interval = std::max(1, std::min(interval, max_interval));
+    }
+
+    schedule.evaluated = true;
+    schedule.next_frame = frame + interval;
+    schedule.last_evaluated_frame = frame;
+    schedule.neighbours = neighbour_count;
+    schedule.signature = neighbour_signature;
+    schedule.force = force;
+}
+
+template <int Dim>
+void BasicUpdateScheduler<Dim>::advance(sf::Time tick) {
+    frame++;
+    if (tick.asSeconds() > 0) {
+        tick_seconds = tick.asSeconds();
+    }
+    full_count = 0;
+    extrapolated_count = 0;
+}
+
+template <int Dim>
+auto BasicUpdateScheduler<Dim>::schedule_for(int id) -> BoidSchedule& {
+    if (static_cast<std::size_t>(id) >= schedules.size()) {
+        schedules.resize(id + 1);
+    }
+    return schedules[id];
+}
+
+template <int Dim>
+float BasicUpdateScheduler<Dim>::distance_from_viewport(Vec position) const {
+    if (not has_viewport) return 0;
+    float distanceSquared = 0;
+    for (int axis = 0; axis < Dim; ++axis) {
+        float c = component(position, axis);
+        float distance = c - clamp(c, component(viewport.min, axis), component(viewport.max, axis));
+        distanceSquared += distance * distance;
+    }
+    return std::sqrt(distanceSquared);
+}
+
+template class BasicUpdateScheduler<2>;
+template class BasicUpdateScheduler<3>;
@@ -0,0 +1,110 @@
+//
+// Temporal level of detail: boids with little going on are fully evaluated only every few frames, and coast on
+// their last steering force in between
+//
+
+#ifndef BOIDS_SCHEDULER_H
+#define BOIDS_SCHEDULER_H
+
+#include <cstdint>
+#include <vector>
+#include <SFML/System.hpp>
+#include "boid.h"
+#include "include/spatial_tree.h"
+
+struct SchedulerSettings
+{
+    /// Largest drift (in world units) a boid is allowed to accumulate between two full evaluations, by the
+    /// scheduler's estimate, while it is inside the viewport. Flocking is chaotic, so these per-interval errors
+    /// still compound over time; use force_full_updates to compare against the exact simulation.
+    float error_tolerance = 0.5f;
+
+    /// Outside the viewport the tolerance grows by one multiple of error_tolerance per `viewport_falloff` units
+    float viewport_falloff = 200.0f;
+
+    /// Longest interval, in frames, between full evaluations inside and outside the viewport
+    int max_interval = 8;
+    int max_offscreen_interval = 32;
+
+    /// Evaluate every boid every frame, for validating the extrapolation against the full simulation
+    bool force_full_updates = false;
+
+    // Limits of the estimate: it extrapolates the activity seen at the last two full evaluations, so a boid
+    // that is asleep cannot react to anything new in its neighbourhood (such as an approaching predator) until
+    // it is next due, up to max_interval frames later (max_offscreen_interval outside the viewport).
+};
+
+/// Decides, per boid, whether this frame needs a full neighbour query and rule evaluation. After each full
+/// evaluation the next interval is chosen from how quickly the steering force and the neighbourhood have been
+/// changing since the previous evaluation. The applied force is a unit direction scaled by max_force, so the
+/// acceleration error of holding it is max_force times the change in direction, and a stale force held for
+/// k frames drifts by about max_force * rate * dt^2 * k^3 / 6. The longest interval that keeps this under
+/// the tolerance is used. Neighbourhood change is the change in neighbour count, or at least one neighbour's
+/// worth if the set of neighbour IDs changed at the same count. Boids with no activity (including isolated
+/// boids) sleep for the maximum interval.
+template <int Dim>
+class BasicUpdateScheduler
+{
+public:
+    using Vec = Vector<Dim>;
+    using Boid = BasicBoid<Dim>;
+
+    explicit BasicUpdateScheduler(SchedulerSettings settings) : settings(settings) {}
+
+    /// Boids outside this box are updated less often. With no viewport set, every boid counts as visible.
+    void set_viewport(Bounds<Dim> p_viewport);
+
+    /// Forgets the history of the boid with this ID, so that a newly spawned boid is evaluated straight away
+    void reset(int id);
+
+    /// True if the boid should be fully evaluated this frame
+    bool due(const Boid& boid) const;
+
+    /// Returns the force to keep applying to a boid that isn't due
+    Vec extrapolate(const Boid& boid);
+
+    /// Records the outcome of a full evaluation and schedules the next one. `neighbour_signature` is the XOR of
+    /// id_signature() over the boid's neighbours.
+    void record(const Boid& boid, Vec force, std::size_t neighbour_count, std::uint32_t neighbour_signature);
+
+    /// Scrambles an ID so that XOR-ing them gives an order-independent signature of a set of boids
+    static std::uint32_t id_signature(int id) {
+        auto h = static_cast<std::uint32_t>(id) * 2654435761u;
+        return h ^ (h >> 16);
+    }
+
+    /// Moves on to the next frame, which was `tick` long
+    void advance(sf::Time tick);
+
+    /// Number of full evaluations and extrapolations since the last advance()
+    std::size_t full_updates() const { return full_count; }
+    std::size_t extrapolated_updates() const { return extrapolated_count; }
+
+    SchedulerSettings settings;
+
+private:
+    struct BoidSchedule {
+        bool evaluated = false;
+        unsigned long next_frame = 0;
+        unsigned long last_evaluated_frame = 0;
+        std::size_t neighbours = 0;
+        std::uint32_t signature = 0;
+        Vec force;
+    };
+
+    std::vector<BoidSchedule> schedules;
+    unsigned long frame = 0;
+    float tick_seconds = 1.0f / 60.0f;
+    bool has_viewport = false;
+    Bounds<Dim> viewport = Bounds<Dim>(Vec(), Vec());
+    std::size_t full_count = 0;
+    std::size_t extrapolated_count = 0;
+
+    BoidSchedule& schedule_for(int id);
+    float distance_from_viewport(Vec position) const;
+};
+
+using UpdateScheduler = BasicUpdateScheduler<2>;
+using UpdateScheduler3 = BasicUpdateScheduler<3>;
+
+#endif //BOIDS_SCHEDULER_H
@@ -0,0 +1,79 @@
+// Checks per-species flock metrics gathered through Flock::steer on a hand-placed flock
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "../flock.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+bool near(float a, float b) {
+    return std::abs(a - b) < 1e-4f;
+}
+
+int main() {
+    BoidParameters params{150, 300, 90, 12, 8};
+    Flock flock(sf::Vector2f(1920, 1080));
+    int boids = flock.add_species("Boids", params);
+    int drifters = flock.add_species("Drifters", params);
+    flock.add_rule(boids, boids, std::make_unique<Cohesion<2>>(1));
+    flock.add_rule(drifters, boids, std::make_unique<Cohesion<2>>(1));
+
+    // A clump of three, a chain of four 30 apart and one isolated boid, all but the isolated one heading right
+    sf::Vector2f right(20, 0);
+    flock.spawn(boids, sf::Vector2f(100, 100), right, sf::Color());
+    flock.spawn(boids, sf::Vector2f(110, 100), right, sf::Color());
+    flock.spawn(boids, sf::Vector2f(100, 120), right, sf::Color());
+    for (int i = 0; i < 4; ++i) {
+        flock.spawn(boids, sf::Vector2f(1000 + 30 * i, 500), right, sf::Color());
+    }
+    flock.spawn(boids, sf::Vector2f(500, 900), sf::Vector2f(0, 20), sf::Color());
+
+    // Drifters sit together but have no rule for their own kind, so they form no clusters
+    flock.spawn(drifters, sf::Vector2f(1500, 200), sf::Vector2f(0, 20), sf::Color());
+    flock.spawn(drifters, sf::Vector2f(1505, 200), sf::Vector2f(0, -20), sf::Color());
+    flock.spawn(drifters, sf::Vector2f(1510, 200), sf::Vector2f(0, 20), sf::Color());
+
+    FlockAnalytics analytics(1);
+    flock.set_analytics(&analytics);
+    flock.steer();
+    CHECK(analytics.published());
+
+    const auto& metrics = analytics.latest();
+    CHECK(metrics.boids == 11);
+    CHECK(metrics.species.size() == 2);
+
+    const auto& flocking = metrics.species[boids];
+    CHECK(flocking.boids == 8);
+    CHECK(near(flocking.polarisation, std::sqrt(50.0f) / 8));
+    CHECK(flocking.perceives_own_species);
+    CHECK(flocking.clusters == 3);
+    CHECK(flocking.largest_cluster == 4);
+    CHECK(flocking.isolated == 1);
+    CHECK(near(flocking.nn_min, 10));
+    CHECK(near(flocking.nn_median, 30));
+    CHECK(near(flocking.nn_max, 30));
+    CHECK(near(flocking.nn_mean, 160.0f / 7));
+
+    const auto& drifting = metrics.species[drifters];
+    CHECK(drifting.boids == 3);
+    CHECK(near(drifting.polarisation, 1.0f / 3));
+    CHECK(not drifting.perceives_own_species);
+    CHECK(drifting.clusters == 0);
+    CHECK(drifting.isolated == 0);
+
+    // Frames between samples publish nothing
+    FlockAnalytics sparse(2);
+    flock.set_analytics(&sparse);
+    flock.steer();
+    CHECK(sparse.published());
+    flock.steer();
+    CHECK(not sparse.published());
+
+    return EXIT_SUCCESS;
+}
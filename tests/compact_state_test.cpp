@@ -0,0 +1,59 @@
+// Checks the quantised encoders against the float state they are decoded back into
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "../include/compact_state.h"
+#include "../vector_utils.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+int main() {
+    std::mt19937 rng(20201018);
+    std::uniform_real_distribution<float> unit(0, 1);
+    const float max_speed = 150;
+
+    float worst_position = 0;
+    float worst_velocity = 0;
+    for (int i = 0; i < 1000000; ++i) {
+        // Leaves from the whole 1920x1080 world down to a few pixels across
+        float width = std::ldexp(1920.0f, -static_cast<int>(unit(rng) * 12));
+        float height = width * 9 / 16;
+        float xmin = unit(rng) * (1920 - width);
+        float ymin = unit(rng) * (1080 - height);
+        RectangleBounds cell(sf::Vector2f(xmin, ymin), sf::Vector2f(xmin + width, ymin + height));
+        sf::Vector2f position(xmin + unit(rng) * width, ymin + unit(rng) * height);
+
+        sf::Vector2f decoded = decode_position(encode_position(position, cell), cell);
+        float position_error = magnitude(decoded - position);
+        CHECK(position_error <= max_position_error(cell));
+        worst_position = std::max(worst_position, position_error / max_position_error(cell));
+
+        float angle = unit(rng) * 2 * PI;
+        float speed = unit(rng) * max_speed;
+        sf::Vector2f velocity(speed * std::cos(angle), speed * std::sin(angle));
+        float velocity_error = magnitude(decode_velocity(encode_velocity(velocity, max_speed), max_speed) - velocity);
+        CHECK(velocity_error <= max_velocity_error(max_speed));
+        worst_velocity = std::max(worst_velocity, velocity_error / max_velocity_error(max_speed));
+    }
+
+    // Edges of the ranges: cell corners, zero velocity, max speed along each axis
+    RectangleBounds world(sf::Vector2f(0, 0), sf::Vector2f(1920, 1080));
+    for (auto corner : {world.min, world.max, sf::Vector2f(world.min.x, world.max.y)}) {
+        CHECK(magnitude(decode_position(encode_position(corner, world), world) - corner) <= max_position_error(world));
+    }
+    CHECK(magnitude(decode_velocity(encode_velocity(sf::Vector2f(0, 0), max_speed), max_speed)) == 0);
+    for (auto velocity : {sf::Vector2f(max_speed, 0), sf::Vector2f(0, -max_speed), sf::Vector2f(-max_speed, 0)}) {
+        CHECK(magnitude(decode_velocity(encode_velocity(velocity, max_speed), max_speed) - velocity)
+              <= max_velocity_error(max_speed));
+    }
+
+    std::cout << "worst error / bound: position " << worst_position << ", velocity " << worst_velocity << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+// Checks handle validity, slot reuse and swap-remove in the Registry
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../include/registry.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+struct Item {
+    Item(int p_value, int p_ID) : value(p_value), ID(p_ID) {}
+    int value;
+    int ID;
+};
+
+int main() {
+    Registry<Item> registry;
+    std::vector<Handle> handles;
+    for (int i = 0; i < 5; ++i) {
+        handles.push_back(registry.spawn(i * 10));
+    }
+    CHECK(registry.size() == 5);
+    for (int i = 0; i < 5; ++i) {
+        CHECK(registry.get(handles[i])->ID == i);
+        CHECK(registry.handle_of(*registry.get(handles[i])) == handles[i]);
+    }
+
+    // Despawning from the middle moves the last item into the gap; its handle must still work
+    Handle removed = handles[1];
+    CHECK(registry.despawn(removed));
+    CHECK(registry.size() == 4);
+    CHECK(registry.get(handles[4]) != nullptr);
+    CHECK(registry.get(handles[4])->value == 40);
+    CHECK(registry.get(handles[4])->ID == 4);
+    int visited = 0;
+    for (auto& item : registry) {
+        CHECK(item->ID != 1);
+        visited++;
+    }
+    CHECK(visited == 4);
+
+    // A stale handle is rejected everywhere
+    CHECK(not registry.contains(removed));
+    CHECK(registry.get(removed) == nullptr);
+    CHECK(not registry.despawn(removed));
+    CHECK(registry.size() == 4);
+
+    // The freed slot is reused with a new generation, and the stale handle still doesn't alias it
+    Handle reused = registry.spawn(99);
+    CHECK(reused.index == removed.index);
+    CHECK(reused.generation == removed.generation + 1);
+    CHECK(registry.get(reused)->value == 99);
+    CHECK(registry.get(reused)->ID == static_cast<int>(removed.index));
+    CHECK(not registry.contains(removed));
+    CHECK(registry.get(removed) == nullptr);
+    CHECK(not registry.despawn(removed));
+    CHECK(registry.contains(reused));
+    CHECK(registry.capacity() == 5);
+
+    // Despawning the last item needs no move
+    CHECK(registry.despawn(handles[4]));
+    CHECK(registry.get(handles[0])->value == 0);
+    CHECK(registry.get(reused)->value == 99);
+
+    // Hooks see every spawn and despawn
+    int spawned = 0;
+    int despawned = 0;
+    registry.on_spawn([&spawned](Item*) { spawned++; });
+    registry.on_despawn([&despawned](Item*) { despawned++; });
+    Handle hooked = registry.spawn(7);
+    registry.despawn(hooked);
+    registry.despawn(hooked);
+    CHECK(spawned == 1);
+    CHECK(despawned == 1);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+// Checks the update scheduler: forced full updates match the unscheduled simulation, idle boids sleep for the
+// configured intervals, and boids spawned into a reused ID are evaluated straight away
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../flock.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+const sf::Time TICK = sf::seconds(1 / 60.0f);
+
+void populate(Flock& flock, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0, 1);
+    int species = flock.add_species("Boids", BoidParameters{150, 300, 90, 12, 8});
+    flock.add_rule(species, species, std::make_unique<Accelerate<2>>(1));
+    flock.add_rule(species, species, std::make_unique<Alignment<2>>(4));
+    flock.add_rule(species, species, std::make_unique<Cohesion<2>>(0.9f));
+    flock.add_rule(species, species, std::make_unique<Separation<2>>(60, 2));
+    auto extent = flock.get_extent();
+    for (int i = 0; i < 1000; ++i) {
+        sf::Vector2f position(unit(rng) * extent.x, unit(rng) * extent.y);
+        sf::Vector2f velocity((unit(rng) - 0.5f) * 100, (unit(rng) - 0.5f) * 100);
+        flock.spawn(species, position, velocity, sf::Color());
+    }
+}
+
+void step(Flock& flock) {
+    flock.rebuild_index();
+    flock.steer();
+    flock.update(TICK);
+}
+
+int main() {
+    // With force_full_updates the scheduled flock must follow the unscheduled one exactly
+    Flock exact(sf::Vector2f(1920, 1080));
+    Flock forced(sf::Vector2f(1920, 1080));
+    populate(exact, 20201018);
+    populate(forced, 20201018);
+    SchedulerSettings settings;
+    settings.force_full_updates = true;
+    UpdateScheduler full(settings);
+    full.set_viewport(RectangleBounds(sf::Vector2f(0, 0), sf::Vector2f(960, 540)));
+    forced.set_scheduler(&full);
+    for (int frame = 0; frame < 120; ++frame) {
+        step(exact);
+        forced.rebuild_index();
+        forced.steer();
+        CHECK(full.full_updates() == forced.get_boids().size());
+        CHECK(full.extrapolated_updates() == 0);
+        forced.update(TICK);
+    }
+    auto exact_boid = exact.get_boids().begin();
+    for (auto& boid : forced.get_boids()) {
+        CHECK((*exact_boid)->ID == boid->ID);
+        CHECK((*exact_boid)->get_position() == boid->get_position());
+        CHECK((*exact_boid)->get_velocity() == boid->get_velocity());
+        ++exact_boid;
+    }
+
+    // An isolated boid is evaluated on its first two frames, then sleeps for the longest interval allowed where
+    // it is: max_interval inside the viewport and max_offscreen_interval outside
+    Flock idle(sf::Vector2f(1920, 1080));
+    int species = idle.add_species("Boids", BoidParameters{150, 300, 90, 12, 8});
+    idle.add_rule(species, species, std::make_unique<Cohesion<2>>(1));
+    Handle onscreen = idle.spawn(species, sf::Vector2f(100, 100), sf::Vector2f(20, 0), sf::Color());
+    Handle offscreen = idle.spawn(species, sf::Vector2f(1500, 800), sf::Vector2f(20, 0), sf::Color());
+    UpdateScheduler scheduler{SchedulerSettings()};
+    scheduler.set_viewport(RectangleBounds(sf::Vector2f(0, 0), sf::Vector2f(960, 540)));
+    idle.set_scheduler(&scheduler);
+
+    std::vector<int> expected_onscreen;
+    std::vector<int> expected_offscreen;
+    const int frames = 70;
+    for (int frame = 0; frame < frames; ++frame) {
+        if (frame < 2 or (frame - 1) % scheduler.settings.max_interval == 0) expected_onscreen.push_back(frame);
+        if (frame < 2 or (frame - 1) % scheduler.settings.max_offscreen_interval == 0) expected_offscreen.push_back(frame);
+    }
+    std::vector<int> onscreen_due;
+    std::vector<int> offscreen_due;
+    for (int frame = 0; frame < frames; ++frame) {
+        if (scheduler.due(*idle.get_boids().get(onscreen))) onscreen_due.push_back(frame);
+        if (scheduler.due(*idle.get_boids().get(offscreen))) offscreen_due.push_back(frame);
+        step(idle);
+    }
+    CHECK(onscreen_due == expected_onscreen);
+    CHECK(offscreen_due == expected_offscreen);
+
+    // A boid spawned into the ID of a sleeping boid must not inherit its schedule
+    CHECK(not scheduler.due(*idle.get_boids().get(onscreen)));
+    int reused_id = idle.get_boids().get(onscreen)->ID;
+    CHECK(idle.despawn(onscreen));
+    Handle spawned = idle.spawn(species, sf::Vector2f(200, 200), sf::Vector2f(0, 20), sf::Color());
+    CHECK(idle.get_boids().get(spawned)->ID == reused_id);
+    CHECK(scheduler.due(*idle.get_boids().get(spawned)));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+// Checks compact snapshots of a simulated flock against the float state they were taken from
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "../flock.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+int main() {
+    std::mt19937 rng(20201018);
+    std::uniform_real_distribution<float> unit(0, 1);
+    BoidParameters params{150, 300, 90, 12, 8};
+    sf::Vector2f extent(1920, 1080);
+
+    Flock flock(extent);
+    int boids = flock.add_species("Boids", params);
+    int others = flock.add_species("Others", params);
+    flock.add_rule(boids, boids, std::make_unique<Separation<2>>(20, 1));
+    flock.add_rule(boids, boids, std::make_unique<Alignment<2>>(1));
+    flock.add_rule(boids, boids, std::make_unique<Cohesion<2>>(1));
+    for (int i = 0; i < 2000; ++i) {
+        sf::Vector2f position(unit(rng) * extent.x, unit(rng) * extent.y);
+        sf::Vector2f velocity((unit(rng) - 0.5f) * 200, (unit(rng) - 0.5f) * 200);
+        flock.spawn(i % 4 == 0 ? others : boids, position, velocity, sf::Color());
+    }
+    for (int step = 0; step < 20; ++step) {
+        flock.rebuild_index();
+        flock.steer();
+        flock.update(sf::seconds(1 / 60.0f));
+    }
+    flock.rebuild_index();
+
+    std::map<std::int32_t, const Boid*> by_id;
+    for (auto& boid : flock.get_boids()) {
+        if (boid->species == boids) by_id[boid->ID] = boid.get();
+    }
+
+    auto snapshot = flock.snapshot(boids);
+    CHECK(snapshot.max_speed == params.max_speed);
+    CHECK(snapshot.states.size() == by_id.size());
+    CHECK(snapshot.ids.size() == snapshot.states.size());
+
+    // Every state decodes to within the error bounds of the boid with its ID, and every boid appears once
+    std::vector<std::int32_t> seen;
+    std::uint32_t next = 0;
+    for (const auto& cell : snapshot.cells) {
+        CHECK(cell.first == next);
+        next += cell.count;
+        for (std::uint32_t i = cell.first; i < cell.first + cell.count; ++i) {
+            auto found = by_id.find(snapshot.ids[i]);
+            CHECK(found != by_id.end());
+            const Boid* boid = found->second;
+            CHECK(magnitude(decode_position(snapshot.states[i].position, cell.bounds) - boid->get_position())
+                  <= max_position_error(cell.bounds));
+            CHECK(magnitude(decode_velocity(snapshot.states[i].velocity, snapshot.max_speed) - boid->get_velocity())
+                  <= max_velocity_error(snapshot.max_speed));
+            seen.push_back(snapshot.ids[i]);
+        }
+    }
+    CHECK(next == snapshot.states.size());
+    std::sort(seen.begin(), seen.end());
+    CHECK(std::adjacent_find(seen.begin(), seen.end()) == seen.end());
+    CHECK(seen.size() == by_id.size());
+
+    std::ostringstream os;
+    snapshot.write(os);
+    CHECK(os.str().size() == sizeof(float) + 2 * sizeof(std::uint32_t) + snapshot.cells.size() * sizeof(CompactCell)
+                             + by_id.size() * (sizeof(CompactBoidState) + sizeof(std::int32_t)));
+
+    // Neighbour queries on the snapshot agree with the layer, except for boids within the position error of the edge
+    float tolerance = max_position_error(RectangleBounds(sf::Vector2f(0, 0), extent));
+    for (int query = 0; query < 500; ++query) {
+        sf::Vector2f centre(unit(rng) * extent.x, unit(rng) * extent.y);
+        float radius = 10 + unit(rng) * 200;
+        std::vector<std::int32_t> expected;
+        for (auto boid : flock.get_layer(boids).getPointsWithinRadius(centre, radius)) {
+            expected.push_back(boid->ID);
+        }
+        auto found = snapshot.ids_within_radius(centre, radius);
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        std::vector<std::int32_t> differences;
+        std::set_symmetric_difference(expected.begin(), expected.end(), found.begin(), found.end(),
+                                      std::back_inserter(differences));
+        for (auto id : differences) {
+            CHECK(std::abs(magnitude(by_id[id]->get_position() - centre) - radius) <= tolerance);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+// Checks spatial tree queries against a brute-force search, in 2D and 3D
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../flock.h"
+
+#define CHECK(condition) \
+    if (not (condition)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+        return EXIT_FAILURE; \
+    }
+
+template <int Dim>
+Vector<Dim> random_vector(std::mt19937& rng, Vector<Dim> extent) {
+    std::uniform_real_distribution<float> unit(0, 1);
+    Vector<Dim> v;
+    for (int axis = 0; axis < Dim; ++axis) {
+        component(v, axis) = unit(rng) * component(extent, axis);
+    }
+    return v;
+}
+
+/// Compares layer queries with a linear scan over every boid in the flock. Returns the number of mismatches.
+template <int Dim>
+int count_query_mismatches(BasicFlock<Dim>& flock, int species, std::mt19937& rng, int queries, float radius) {
+    int mismatches = 0;
+    for (int i = 0; i < queries; ++i) {
+        auto centre = random_vector<Dim>(rng, flock.get_extent());
+        auto found = flock.get_layer(species).getPointsWithinRadius(centre, radius);
+        std::vector<BasicBoid<Dim>*> expected;
+        for (auto& boid : flock.get_boids()) {
+            if (magnitude(boid->get_position() - centre) < radius) {
+                expected.push_back(boid.get());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        if (found != expected) mismatches++;
+    }
+    return mismatches;
+}
+
+int main() {
+    std::mt19937 rng(20201018);
+    BoidParameters params{150, 300, 90, 12, 8};
+
+    Flock3 flock3(sf::Vector3f(1000, 800, 600));
+    int species3 = flock3.add_species("Boids", params);
+    for (int i = 0; i < 3000; ++i) {
+        flock3.spawn(species3, random_vector<3>(rng, flock3.get_extent()), sf::Vector3f(20, 0, 0), sf::Color());
+    }
+    flock3.rebuild_index();
+    CHECK(count_query_mismatches(flock3, species3, rng, 200, 90) == 0);
+
+    Flock flock2(sf::Vector2f(1920, 1080));
+    int species2 = flock2.add_species("Boids", params);
+    for (int i = 0; i < 3000; ++i) {
+        flock2.spawn(species2, random_vector<2>(rng, flock2.get_extent()), sf::Vector2f(20, 0), sf::Color());
+    }
+    flock2.rebuild_index();
+    CHECK(count_query_mismatches(flock2, species2, rng, 200, 90) == 0);
+
+    // Boids that have moved since the last rebuild must still be removed from their layer when despawned
+    Flock moving(sf::Vector2f(1920, 1080));
+    int species = moving.add_species("Boids", params);
+    std::vector<Handle> handles;
+    for (int i = 0; i < 50; ++i) {
+        handles.push_back(moving.spawn(species, sf::Vector2f(959.9f, 539.9f + i * 0.001f),
+                                       sf::Vector2f(100, 100), sf::Color()));
+    }
+    moving.rebuild_index();
+    moving.update(sf::seconds(0.1f));
+    for (auto handle : handles) {
+        CHECK(moving.despawn(handle));
+    }
+    CHECK(moving.get_layer(species).getPointsWithinRadius(sf::Vector2f(960, 540), 1000).empty());
+
+    // An emitter spawning many boids at one point must not split the tree forever
+    Flock emitter(sf::Vector2f(1920, 1080));
+    int emitted = emitter.add_species("Boids", params);
+    for (int i = 0; i < 100; ++i) {
+        emitter.spawn(emitted, sf::Vector2f(500, 500), sf::Vector2f(20, 0), sf::Color());
+    }
+    CHECK(emitter.get_layer(emitted).getPointsWithinRadius(sf::Vector2f(500, 500), 1).size() == 100);
+    emitter.rebuild_index();
+    CHECK(emitter.get_layer(emitted).getPointsWithinRadius(sf::Vector2f(500, 500), 1).size() == 100);
+
+    return EXIT_SUCCESS;
+}
@@ -10,15 +10,48 @@
 
 const float PI = 3.14159265358979323846;
 
+/// Vector<2> is sf::Vector2f and Vector<3> is sf::Vector3f, so the 2D code is the same as a non-generic version
+template <int Dim> struct VectorType;
+template <> struct VectorType<2> { using type = sf::Vector2f; };
+template <> struct VectorType<3> { using type = sf::Vector3f; };
+
+template <int Dim>
+using Vector = typename VectorType<Dim>::type;
+
+inline float component(const sf::Vector2f& v, int axis) {
+    return axis == 0 ? v.x : v.y;
+}
+
+inline float component(const sf::Vector3f& v, int axis) {
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+inline float& component(sf::Vector2f& v, int axis) {
+    return axis == 0 ? v.x : v.y;
+}
+
+inline float& component(sf::Vector3f& v, int axis) {
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
 inline float magnitude(sf::Vector2f v) {
     return std::sqrt(v.x * v.x + v.y * v.y);
 }
 
+inline float magnitude(sf::Vector3f v) {
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
 inline sf::Vector2f normalise(sf::Vector2f v) {
     float mag = magnitude(v);
     return mag > 0 ? v / magnitude(v) : v;
 }
 
+inline sf::Vector3f normalise(sf::Vector3f v) {
+    float mag = magnitude(v);
+    return mag > 0 ? v / mag : v;
+}
+
 inline float vector_to_rotation(sf::Vector2f vector) {
     float x = vector.x;
     float y = vector.y;
@@ -58,4 +91,10 @@ inline std::string to_str(sf::Vector2f vec) {
     return ss.str();
 }
 
+inline std::string to_str(sf::Vector3f vec) {
+    std::stringstream ss;
+    ss << "(" << vec.x << ", " << vec.y << ", " << vec.z << ") [" << magnitude(vec) << "]";
+    return ss.str();
+}
+
 #endif //BOIDS_VECTOR_UTILS_H